@@ -0,0 +1,113 @@
+#!/bin/bash
+# Runs the benchmark suite on a single machine with charmrun ++local.
+# Usage: ./run_bench.sh [quick|full] [csv|json]
+# Environment: PES (default: number of cores), CHARES_PER_PE (default: 4),
+#              OUT (default: results.<format>), SEED (default: 1)
+
+suite=${1:-quick}
+format=${2:-csv}
+PES=${PES:-$(nproc)}
+CHARES_PER_PE=${CHARES_PER_PE:-4}
+OUT=${OUT:-results.$format}
+SEED=${SEED:-1}
+chares=$(expr $PES \* $CHARES_PER_PE)
+
+# generator scale param
+if [ "$suite" == "full" ]
+then
+    configs="mesh2d 4096 0.4
+mesh2d 4096 0.6
+mesh3d 256 0.3
+mesh3d 256 0.5
+rmat 22 8
+rmat 24 16
+path 16777216 0
+path 16777216 1
+star 16777216 0
+rgg 4194304 0.006"
+else
+    configs="mesh2d 512 0.4
+mesh2d 512 0.6
+mesh3d 64 0.3
+rmat 16 8
+path 1000000 0
+path 1000000 1
+star 1000000 0
+rgg 262144 0.015"
+fi
+
+# run one variant of the current configuration: description, charmrun PE
+# count, then bench options. Every variant must find the same number of
+# components as the first run of the configuration.
+run_variant() {
+    description=$1
+    pes=$2
+    shift 2
+    echo "Running $generator $scale $param with $description"
+    ./charmrun +p$pes ./bench $generator $chares $scale $param -seed $SEED \
+        -format $format -out $OUT "$@" ++local > bench.log
+    record=`grep "\[Bench\]" bench.log`
+    if [ "$record" == "" ]
+    then
+        echo "Run failed, see bench.log"
+        exit 1
+    fi
+    if [ "$format" == "json" ]
+    then
+        components=`echo "$record" | grep -o '"components": [0-9]*' | cut -d " " -f 2`
+    else
+        components=`echo "$record" | cut -d "," -f 12`
+    fi
+    if [ "$expected" == "" ]
+    then
+        expected=$components
+    elif [ "$components" != "$expected" ]
+    then
+        echo "Component count mismatch: $components with $description, $expected before; see bench.log"
+        exit 1
+    fi
+}
+
+echo "$configs" | while read generator scale param; do
+    expected=""
+    for algo in findboss anchor rem; do
+        for labeling in needboss pj; do
+            run_variant "$algo/$labeling on $PES PEs, $chares chares" $PES -algorithm $algo -labeling $labeling
+        done
+        # prioritized path updates, completing unions and long queue replies
+        run_variant "$algo and message priorities on $PES PEs" $PES -algorithm $algo -priority all
+        # library chares of a process share their trees
+        run_variant "$algo and a node-shared forest on $PES PEs" $PES -algorithm $algo -engine node
+        # completion detection from the library's own message counts
+        run_variant "$algo and counted completion on $PES PEs" $PES -algorithm $algo -completion counted
+        # redundant edges dropped before they are sent
+        run_variant "$algo and the edge filter on $PES PEs" $PES -algorithm $algo -filter -nobuffer
+        # two-stage Phase 1 with giant component sampling
+        run_variant "$algo and sampling on $PES PEs" $PES -algorithm $algo -sample 2
+        # edges fed in batches with incremental labeling, then components
+        # reset and their edges resubmitted
+        run_variant "$algo and incremental epochs on $PES PEs" $PES -algorithm $algo -epochs 4
+        run_variant "$algo and invalidation on $PES PEs" $PES -algorithm $algo -epochs 2 -invalidate
+        # batched same-component queries between Phase 1 and labeling
+        run_variant "$algo and queries on $PES PEs" $PES -algorithm $algo -queries 1000
+        # components labeled with their root IDs
+        run_variant "$algo and root ID numbering on $PES PEs" $PES -algorithm $algo -numbering rootid
+        # every library chare and its piece migrate between Phase 1 and labeling
+        run_variant "$algo and load balancing on $PES PEs" $PES -algorithm $algo -lb +balancer RotateLB
+        # two library instances bound to the pieces, run at the same time
+        run_variant "$algo and two library instances on $PES PEs" $PES -algorithm $algo -instances 2
+    done
+    # the library links the rgg points itself
+    if [ "$generator" == "rgg" ]
+    then
+        run_variant "geometric linking on $PES PEs" $PES -geometric
+        # three linking lengths, the last one is the run's own
+        run_variant "multi-level clustering on $PES PEs" $PES -levels 3
+    fi
+    # center of mass and bounding box catalog before pruning
+    run_variant "the component catalog on $PES PEs" $PES -catalog
+    # shared-memory engine, one process with $PES threads
+    run_variant "the shared engine, $PES threads" 1 -engine shared -threads $PES
+done || exit 1
+rm -f bench.log
+echo "Results in $OUT"
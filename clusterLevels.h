@@ -0,0 +1,39 @@
+#ifndef CLUSTER_LEVELS
+#define CLUSTER_LEVELS
+
+#include <vector>
+
+// included by unionFindLib.h, after the Charm++ declarations
+class UnionFindLib;
+
+/* Multi-threshold clustering (UnionFindLib::cluster_weighted_edges)
+   Feeds the weighted edges of its library chare level by level and keeps
+   the labels of the first level, the labels that changed at every later
+   level, and the component counts of all levels.
+   One per library chare; entry methods of the chare forward to it.
+*/
+class levelClusterer {
+    // edges of the levels not yet sent, and the labels and component counts
+    // of the levels done
+    std::vector< std::vector<long int> > clusterLevelEdges;
+    std::vector<long int> firstLevelLabels;
+    std::vector<long int> previousLevelLabels; // only while clustering
+    std::vector<long int> levelChangeStarts; // first change of every later level, and the end
+    std::vector<int> changedVertices; // local indices, ascending within a level
+    std::vector<long int> changedLabels;
+    std::vector<long int> levelComponentCounts;
+    bool callerIncrementalLabeling = false; // restored after the last level
+    CkCallback postClusteringCb;
+
+    void start_cluster_level(UnionFindLib &lib);
+
+    public:
+    void cluster_weighted_edges(UnionFindLib &lib, const long int *edgeList, const double *weights,
+            long int numEdges, const std::vector<double> &thresholds, CkCallback cb);
+    void cluster_level_unions_done(UnionFindLib &lib);
+    void cluster_level_labeled(UnionFindLib &lib);
+    long int get_level_component(int level, int arrIdx) const;
+    void pup(PUP::er &p);
+};
+
+#endif
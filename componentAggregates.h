@@ -0,0 +1,64 @@
+#ifndef COMPONENT_AGGREGATES
+#define COMPONENT_AGGREGATES
+
+#include <vector>
+
+// included by unionFindLib.h, after the Charm++ declarations
+class UnionFindLib;
+
+// combine operators of per-component aggregates, applied per value
+enum aggregateOperator {
+    AGGREGATE_SUM, // masses, member counts; vector sums with width > 1
+    AGGREGATE_MIN, // e.g. lower corners of bounding boxes
+    AGGREGATE_MAX
+};
+
+/* Per-component aggregates (UnionFindLib::aggregate_components)
+   Folds the payloads registered on its library chare per component and,
+   on owner chares, combines the partial rows into the catalog.
+   One per library chare; entry methods of the chare forward to it.
+*/
+class componentAggregator {
+    // registered payloads, one row of all aggregates per vertex, and on
+    // owners the partial rows received and the combined rows of owned
+    // components
+    std::vector<int> aggregateOps; // aggregateOperator of each aggregate
+    std::vector<int> aggregateWidths;
+    std::vector<int> aggregateOffsets; // first value of each aggregate in a row
+    int aggregateRowWidth = 0;
+    std::vector< std::vector<double> > aggregateInputs; // width values per local vertex
+    std::vector<long int> receivedAggregateComponents;
+    std::vector<long int> receivedAggregateCounts;
+    std::vector<double> receivedAggregateValues;
+    std::vector<long int> aggregateComponents; // sorted
+    std::vector<long int> aggregateCounts;
+    std::vector<double> aggregateValues;
+    long int aggregateThreshold = 0;
+    CkCallback postAggregationCb;
+
+    void combine_aggregate_rows(double *into, const double *from) const;
+
+    public:
+    int register_aggregate(UnionFindLib &lib, const double *values, int width, aggregateOperator op);
+    void clear_aggregates();
+    void aggregate_components(UnionFindLib &lib, long int threshold, CkCallback cb);
+    void add_component_aggregates(UnionFindLib &lib, const std::vector<long int> &comps,
+            const std::vector<long int> &counts, const std::vector<double> &rows);
+    void finish_component_aggregates(UnionFindLib &lib);
+    // results of the components owned by this chare, sorted by component
+    int num_aggregated_components() const {
+        return aggregateComponents.size();
+    }
+    long int get_aggregated_component(int k) const {
+        return aggregateComponents[k];
+    }
+    long int get_aggregated_count(int k) const {
+        return aggregateCounts[k];
+    }
+    const double* get_aggregated_values(int k, int aggregate) const {
+        return &aggregateValues[k * aggregateRowWidth + aggregateOffsets[aggregate]];
+    }
+    void pup(PUP::er &p);
+};
+
+#endif
@@ -0,0 +1,118 @@
+#ifndef GRAPH_BIN_H
+#define GRAPH_BIN_H
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+/* Binary graph format (.bin), produced from .g files by g2bin
+   [binGraphHeader]
+   [binChareRange x (numChares+1)]  range of chare c is [entry c, entry c+1)
+   [binVertex x numVertices]        vertices bucketed by owner chare
+   [binEdge x numEdges]             edges bucketed by owner of first endpoint
+   Vertices are distributed cyclically over numChares with IDs starting from 1,
+   as in the text loader, and each bucket is sorted by vertex ID. Each chare
+   maps only its own vertex and edge ranges.
+*/
+
+#define BIN_GRAPH_MAGIC "UFGRAPH"
+#define BIN_GRAPH_VERSION 1
+
+struct binGraphHeader {
+    char magic[8];
+    int version;
+    int numChares;
+    long int numVertices;
+    long int numEdges;
+    long int chareIndexOffset;
+    long int vertexTableOffset;
+    long int edgeListOffset;
+};
+
+struct binChareRange {
+    long int firstVertex;
+    long int firstEdge;
+};
+
+struct binVertex {
+    long int id;
+    float x, y, z;
+    char complexType;
+    char pad[3];
+};
+
+// laid out as two consecutive long ints, see UnionFindLib::union_requests
+struct binEdge {
+    long int v1;
+    long int v2;
+};
+
+// read-only mapping of [offset, offset+length) of a file
+struct mappedRange {
+    void *base;
+    size_t mappedLength;
+    const char *data;
+};
+
+bool isBinaryGraph(const std::string &filename) {
+    return filename.size() > 4 && filename.compare(filename.size() - 4, 4, ".bin") == 0;
+}
+
+bool readBinaryHeader(const char *filename, binGraphHeader &header) {
+    FILE *fp = fopen(filename, "rb");
+    if (fp == NULL) {
+        printf("File not found\n");
+        return false;
+    }
+    size_t n = fread(&header, sizeof(binGraphHeader), 1, fp);
+    fclose(fp);
+    if (n != 1 || strncmp(header.magic, BIN_GRAPH_MAGIC, sizeof(header.magic)) != 0
+            || header.version != BIN_GRAPH_VERSION) {
+        printf("Not a binary graph file: %s\n", filename);
+        return false;
+    }
+    return true;
+}
+
+// mmap needs a page aligned offset, map from the enclosing page
+const char* mapBinaryRange(int fd, long int offset, long int length, mappedRange &range) {
+    range.base = NULL;
+    range.mappedLength = 0;
+    range.data = NULL;
+    if (length == 0)
+        return NULL;
+    long int pageSize = sysconf(_SC_PAGESIZE);
+    long int alignedOffset = offset - (offset % pageSize);
+    range.mappedLength = length + (offset - alignedOffset);
+    range.base = mmap(NULL, range.mappedLength, PROT_READ, MAP_PRIVATE, fd, alignedOffset);
+    if (range.base == MAP_FAILED) {
+        perror("mmap");
+        range.base = NULL;
+        return NULL;
+    }
+    range.data = (const char*)range.base + (offset - alignedOffset);
+    return range.data;
+}
+
+void unmapBinaryRange(mappedRange &range) {
+    if (range.base != NULL)
+        munmap(range.base, range.mappedLength);
+    range.base = NULL;
+    range.data = NULL;
+}
+
+// vertex and edge ranges of one chare, read with two small preads
+bool readChareRanges(int fd, const binGraphHeader &header, int chareIdx,
+        binChareRange &begin, binChareRange &end) {
+    off_t offset = header.chareIndexOffset + (off_t)chareIdx * sizeof(binChareRange);
+    if (pread(fd, &begin, sizeof(binChareRange), offset) != sizeof(binChareRange))
+        return false;
+    if (pread(fd, &end, sizeof(binChareRange), offset + sizeof(binChareRange)) != sizeof(binChareRange))
+        return false;
+    return true;
+}
+
+#endif
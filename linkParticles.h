@@ -0,0 +1,58 @@
+#ifndef LINK_PARTICLES
+#define LINK_PARTICLES
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// included by unionFindLib.h, after the Charm++ declarations
+class UnionFindLib;
+
+// bounding box of the particles of one chare, gathered by link_particles;
+// empty boxes have lo > hi
+struct particleBox {
+    int chareIdx;
+    double lo[3];
+    double hi[3];
+};
+PUPbytes(particleBox)
+
+/* Geometric front end (UnionFindLib::link_particles)
+   Turns particle positions into union requests of its library chare: local
+   particles are binned into a cell grid no finer than the linking length,
+   kept until all ghost particles from neighbor chares are linked.
+   One per library chare; entry methods of the chare forward to it.
+*/
+class particleLinker {
+    double linkingLength = 0;
+    double cellSize = 0;
+    std::vector<double> particlePositions; // x, y, z per local vertex
+    particleBox myParticleBox;
+    int cellDims[3];
+    std::vector<int> cellParticles; // local indices sorted by cell
+    std::unordered_map<long int, std::pair<int, int> > cellRanges; // cell key -> range in cellParticles
+    int pendingGhostBatches = 0; // may go below 0 until the boxes are gathered
+    bool particleBoxesGathered = false;
+    CkCallback particleLinkingCb;
+
+    bool particle_cell(const double *pos, int cell[3]) const;
+    inline long int cell_key(int cx, int cy, int cz) const {
+        return ((long int)cx * cellDims[1] + cy) * cellDims[2] + cz;
+    }
+    inline bool within_linking_length(const double *p, const double *q) const {
+        double d0 = p[0] - q[0], d1 = p[1] - q[1], d2 = p[2] - q[2];
+        return d0*d0 + d1*d1 + d2*d2 <= linkingLength * linkingLength;
+    }
+    void link_local_particles(UnionFindLib &lib, int i, int j);
+    void check_ghost_particles_done(UnionFindLib &lib);
+
+    public:
+    void link_particles(UnionFindLib &lib, const double *positions, int numParticles,
+            double linkLength, CkCallback cb);
+    void particle_boxes_gathered(UnionFindLib &lib, CkReductionMsg *msg);
+    void link_ghost_particles(UnionFindLib &lib, const std::vector<long int> &ghostIDs,
+            const std::vector<double> &ghostPositions);
+    void pup(PUP::er &p);
+};
+
+#endif
@@ -0,0 +1,248 @@
+#ifndef UNION_FIND_LOCATORS
+#define UNION_FIND_LOCATORS
+
+#include <algorithm>
+#include <utility>
+
+/* Vertex locator policies
+   A locator maps a vertex ID to (chare index, array index in chare).
+   Each policy is a small value type with an inline locate() so that the
+   library's tree climbing loops do not go through a function pointer.
+   Divides and modulos are replaced by shifts and masks whenever the
+   relevant sizes are powers of two.
+*/
+
+inline bool is_power_of_two(long int x) {
+    return x > 0 && (x & (x - 1)) == 0;
+}
+
+inline int log2_of_power_of_two(long int x) {
+    int shift = 0;
+    while ((1L << shift) < x)
+        shift++;
+    return shift;
+}
+
+// contiguous blocks of verticesPerChare vertices, starting at firstID
+struct blockLocator {
+    long int firstID;
+    long int verticesPerChare;
+    bool pow2;
+    int shift;
+    long int mask;
+
+    blockLocator() {}
+    blockLocator(long int perChare, long int first = 0) {
+        firstID = first;
+        verticesPerChare = perChare;
+        pow2 = is_power_of_two(perChare);
+        shift = pow2 ? log2_of_power_of_two(perChare) : 0;
+        mask = perChare - 1;
+    }
+
+    inline std::pair<int, int> locate(long int vid) const {
+        long int offset = vid - firstID;
+        if (pow2)
+            return std::make_pair((int)(offset >> shift), (int)(offset & mask));
+        return std::make_pair((int)(offset / verticesPerChare), (int)(offset % verticesPerChare));
+    }
+};
+
+// round-robin distribution of vertices over numChares, starting at firstID
+struct cyclicLocator {
+    long int firstID;
+    int numChares;
+    bool pow2;
+    int shift;
+    long int mask;
+
+    cyclicLocator() {}
+    cyclicLocator(int nChares, long int first = 0) {
+        firstID = first;
+        numChares = nChares;
+        pow2 = is_power_of_two(nChares);
+        shift = pow2 ? log2_of_power_of_two(nChares) : 0;
+        mask = nChares - 1;
+    }
+
+    inline std::pair<int, int> locate(long int vid) const {
+        long int offset = vid - firstID;
+        if (pow2)
+            return std::make_pair((int)(offset & mask), (int)(offset >> shift));
+        return std::make_pair((int)(offset % numChares), (int)(offset / numChares));
+    }
+};
+
+// square 2-D mesh with vid = x*meshSize + y, split into square tiles of
+// pieceSize x pieceSize; chares and vertices inside a tile are row-major
+struct tile2DLocator {
+    long int meshSize;
+    long int pieceSize;
+    long int piecesPerDim;
+    bool pow2;
+    int meshShift, pieceShift, piecesShift;
+
+    tile2DLocator() {}
+    tile2DLocator(long int mSize, long int pSize) {
+        meshSize = mSize;
+        pieceSize = pSize;
+        piecesPerDim = mSize / pSize;
+        pow2 = is_power_of_two(mSize) && is_power_of_two(pSize);
+        meshShift = pow2 ? log2_of_power_of_two(mSize) : 0;
+        pieceShift = pow2 ? log2_of_power_of_two(pSize) : 0;
+        piecesShift = meshShift - pieceShift;
+    }
+
+    inline std::pair<int, int> locate(long int vid) const {
+        if (pow2) {
+            long int global_y = vid & (meshSize - 1);
+            long int global_x = vid >> meshShift;
+            long int local_x = global_x & (pieceSize - 1);
+            long int local_y = global_y & (pieceSize - 1);
+            long int chareIdx = ((global_x >> pieceShift) << piecesShift) + (global_y >> pieceShift);
+            long int arrIdx = (local_x << pieceShift) + local_y;
+            return std::make_pair((int)chareIdx, (int)arrIdx);
+        }
+        long int global_y = vid % meshSize;
+        long int global_x = vid / meshSize;
+        long int chareIdx = (global_x / pieceSize) * piecesPerDim + (global_y / pieceSize);
+        long int arrIdx = (global_x % pieceSize) * pieceSize + (global_y % pieceSize);
+        return std::make_pair((int)chareIdx, (int)arrIdx);
+    }
+};
+
+// cubic 3-D mesh with vid = (x*meshSize + y)*meshSize + z, split into
+// cubic tiles of pieceSize^3; chares and vertices inside a tile use the same order
+struct tile3DLocator {
+    long int meshSize;
+    long int pieceSize;
+    long int piecesPerDim;
+    bool pow2;
+    int meshShift, pieceShift, piecesShift;
+
+    tile3DLocator() {}
+    tile3DLocator(long int mSize, long int pSize) {
+        meshSize = mSize;
+        pieceSize = pSize;
+        piecesPerDim = mSize / pSize;
+        pow2 = is_power_of_two(mSize) && is_power_of_two(pSize);
+        meshShift = pow2 ? log2_of_power_of_two(mSize) : 0;
+        pieceShift = pow2 ? log2_of_power_of_two(pSize) : 0;
+        piecesShift = meshShift - pieceShift;
+    }
+
+    inline std::pair<int, int> locate(long int vid) const {
+        long int gx, gy, gz;
+        if (pow2) {
+            long int m = meshSize - 1, p = pieceSize - 1;
+            gz = vid & m;
+            gy = (vid >> meshShift) & m;
+            gx = vid >> (2*meshShift);
+            long int chareIdx = ((((gx >> pieceShift) << piecesShift) + (gy >> pieceShift)) << piecesShift) + (gz >> pieceShift);
+            long int arrIdx = ((((gx & p) << pieceShift) + (gy & p)) << pieceShift) + (gz & p);
+            return std::make_pair((int)chareIdx, (int)arrIdx);
+        }
+        gz = vid % meshSize;
+        gy = (vid / meshSize) % meshSize;
+        gx = vid / (meshSize * meshSize);
+        long int chareIdx = ((gx / pieceSize) * piecesPerDim + (gy / pieceSize)) * piecesPerDim + (gz / pieceSize);
+        long int arrIdx = ((gx % pieceSize) * pieceSize + (gy % pieceSize)) * pieceSize + (gz % pieceSize);
+        return std::make_pair((int)chareIdx, (int)arrIdx);
+    }
+};
+
+// arbitrary mapping stored in application-owned tables indexed by vid-firstID
+struct tableLocator {
+    const int *chareOf;
+    const int *indexOf;
+    long int firstID;
+
+    tableLocator() {}
+    tableLocator(const int *chares, const int *indices, long int first = 0) {
+        chareOf = chares;
+        indexOf = indices;
+        firstID = first;
+    }
+
+    inline std::pair<int, int> locate(long int vid) const {
+        return std::make_pair(chareOf[vid - firstID], indexOf[vid - firstID]);
+    }
+};
+
+// contiguous blocks of varying size: chare c holds IDs firstIDs[c] up to
+// firstIDs[c+1]-1; firstIDs has numChares+1 entries, e.g. the blocks made
+// by UnionFindLib::partition_vertices
+struct rangeLocator {
+    const long int *firstIDs;
+    int numChares;
+
+    rangeLocator() {}
+    rangeLocator(const long int *first, int nChares) {
+        firstIDs = first;
+        numChares = nChares;
+    }
+
+    inline std::pair<int, int> locate(long int vid) const {
+        int chareIdx = std::upper_bound(firstIDs, firstIDs + numChares + 1, vid) - firstIDs - 1;
+        return std::make_pair(chareIdx, (int)(vid - firstIDs[chareIdx]));
+    }
+};
+
+// locator used by the library: one of the policies above, or the
+// application's getLocationFromID function as a fallback
+class vertexLocator {
+    public:
+    enum locatorKind {
+        FUNCTION_LOCATOR,
+        BLOCK_LOCATOR,
+        CYCLIC_LOCATOR,
+        TILE2D_LOCATOR,
+        TILE3D_LOCATOR,
+        TABLE_LOCATOR,
+        RANGE_LOCATOR
+    };
+
+    vertexLocator() : kind(FUNCTION_LOCATOR), gloc(NULL) {}
+    vertexLocator(std::pair<int, int> (*f)(long int)) : kind(FUNCTION_LOCATOR), gloc(f) {}
+    vertexLocator(const blockLocator &l) : kind(BLOCK_LOCATOR), block(l) {}
+    vertexLocator(const cyclicLocator &l) : kind(CYCLIC_LOCATOR), cyclic(l) {}
+    vertexLocator(const tile2DLocator &l) : kind(TILE2D_LOCATOR), tile2D(l) {}
+    vertexLocator(const tile3DLocator &l) : kind(TILE3D_LOCATOR), tile3D(l) {}
+    vertexLocator(const tableLocator &l) : kind(TABLE_LOCATOR), table(l) {}
+    vertexLocator(const rangeLocator &l) : kind(RANGE_LOCATOR), range(l) {}
+
+    inline std::pair<int, int> locate(long int vid) const {
+        switch (kind) {
+            case BLOCK_LOCATOR:
+                return block.locate(vid);
+            case CYCLIC_LOCATOR:
+                return cyclic.locate(vid);
+            case TILE2D_LOCATOR:
+                return tile2D.locate(vid);
+            case TILE3D_LOCATOR:
+                return tile3D.locate(vid);
+            case TABLE_LOCATOR:
+                return table.locate(vid);
+            case RANGE_LOCATOR:
+                return range.locate(vid);
+            default:
+                return gloc(vid);
+        }
+    }
+
+    locatorKind get_kind() const {
+        return kind;
+    }
+
+    private:
+    locatorKind kind;
+    std::pair<int, int> (*gloc)(long int vid);
+    blockLocator block;
+    cyclicLocator cyclic;
+    tile2DLocator tile2D;
+    tile3DLocator tile3D;
+    tableLocator table;
+    rangeLocator range;
+};
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef PARTITION_VERTICES
+#define PARTITION_VERTICES
+
+#include <unordered_map>
+#include <vector>
+
+// included by unionFindLib.h, after the Charm++ declarations
+class UnionFindLib;
+
+// sample keys contributed by every chare to choose partition_vertices splitters
+const int PARTITION_SAMPLES = 64;
+
+/* Locality-aware partitioning (UnionFindLib::partition_vertices)
+   Redistributes the vertices handed to its library chare by position and
+   renumbers them and their edges before the library vertices are
+   initialized.
+   One per library chare; entry methods of the chare forward to it.
+*/
+class vertexPartitioner {
+    // original IDs, positions and Morton keys of the vertices, first the
+    // ones handed in, then the ones received, in key order once all arrived
+    std::vector<long int> partitionIDs;
+    std::vector<double> partitionPositions;
+    std::vector<long int> partitionKeys;
+    std::vector<long int> partitionEdges; // original IDs, new IDs once remapped
+    vertexLocator partitionInputLocator; // holder of an original ID
+    std::vector<long int> partitionFirstIDs; // first new ID of every chare, and the total
+    std::unordered_map<long int, long int> partitionNewIDs; // original ID -> new ID
+    long int partitionReceived = 0;
+    bool partitionCountsKnown = false;
+    CkCallback postPartitionCb;
+
+    void check_partition_vertices_arrived(UnionFindLib &lib);
+
+    public:
+    void partition_vertices(UnionFindLib &lib, const long int *vids, const double *positions,
+            int numVertices, const long int *edgeList, long int numEdges,
+            const vertexLocator &inputLocator, CkCallback cb);
+    void partition_bounds_found(UnionFindLib &lib, CkReductionMsg *msg);
+    void partition_samples_gathered(UnionFindLib &lib, CkReductionMsg *msg);
+    void receive_partition_vertices(UnionFindLib &lib, const std::vector<long int> &ids,
+            const std::vector<long int> &keys, const std::vector<double> &positions);
+    void partition_counts_done(UnionFindLib &lib, CkReductionMsg *msg);
+    void store_partition_ids(UnionFindLib &lib, const std::vector<long int> &oldIDs,
+            const std::vector<long int> &newIDs);
+    void partition_directory_done(UnionFindLib &lib);
+    void lookup_partition_ids(UnionFindLib &lib, int fromChare, const std::vector<long int> &oldIDs);
+    void receive_partition_ids(UnionFindLib &lib, const std::vector<long int> &oldIDs,
+            const std::vector<long int> &newIDs);
+    void partition_lookups_done(UnionFindLib &lib);
+    void union_partitioned_edges(UnionFindLib &lib);
+    const std::vector<long int>& get_partitioned_ids() const {
+        return partitionIDs;
+    }
+    const std::vector<double>& get_partitioned_positions() const {
+        return partitionPositions;
+    }
+    void restore_locator(UnionFindLib &lib) const;
+    void pup(PUP::er &p);
+};
+
+#endif
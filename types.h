@@ -1,35 +1,86 @@
+/* Items of the aggregated (TRAM) entry methods. Vertices on the receiving
+   chare are addressed by local index, other vertices by full 64-bit ID.
+   IDs are stored as two 32-bit words so that items only need 4-byte
+   alignment and carry no padding, and flags share a word with the hop count.
+*/
+
+// 64-bit vertex ID with 4-byte alignment
+struct packedID {
+    uint32_t lo;
+    uint32_t hi;
+
+    inline packedID& operator=(long int id) {
+        lo = (uint32_t)((uint64_t)id);
+        hi = (uint32_t)((uint64_t)id >> 32);
+        return *this;
+    }
+    inline operator long int() const {
+        return (long int)(((uint64_t)hi << 32) | lo);
+    }
+    void pup(PUP::er &p) {
+        p|lo;
+        p|hi;
+    }
+};
+
+// find_boss1/find_boss2 step, 24 bytes
 struct findBossData {
-    uint64_t arrIdx;
-    uint64_t partnerOrBossID;
-    uint64_t senderID;
-    uint64_t isFBOne;
+    uint32_t arrIdx;
+    uint32_t isFBOne : 1;
+    uint32_t hops : 31; // parent pointers followed so far, for statistics
+    packedID partnerOrBossID;
+    packedID senderID;
+
+    void pup(PUP::er &p) {
+        // the bit fields cannot be pupped one by one
+        p((char*)this, sizeof(findBossData));
+    }
+};
+
+// need_boss request of vertex requestorIdx of chare requestorChare, 12 bytes
+struct needBossData {
+    uint32_t arrIdx;
+    uint32_t requestorChare;
+    uint32_t requestorIdx;
 
     void pup(PUP::er &p) {
         p|arrIdx;
-        p|partnerOrBossID;
-        p|senderID;
-        p|isFBOne;
+        p|requestorChare;
+        p|requestorIdx;
     }
 };
 
-#ifdef ANCHOR_ALGO
+// anchor step, also used for the steps of Rem's algorithm, 16 bytes
 struct anchorData {
-    uint64_t arrIdx;
-    uint64_t v;
+    uint32_t arrIdx;
+    uint32_t hops; // steps taken so far, for statistics
+    packedID v;
 
     void pup(PUP::er &p) {
         p|arrIdx;
+        p|hops;
         p|v;
     }
 };
-#endif
 
+// 12 bytes
 struct shortCircuitData {
-    uint64_t arrIdx;
-    uint64_t grandparentID;
+    uint32_t arrIdx;
+    packedID grandparentID;
 
     void pup(PUP::er &p) {
         p|arrIdx;
         p|grandparentID;
     }
 };
+
+// {component, count} entry of a sparse count map, sorted by compNum
+struct componentCountMap {
+    long int compNum;
+    long int count;
+
+    void pup(PUP::er &p) {
+        p|compNum;
+        p|count;
+    }
+};
@@ -3,111 +3,589 @@
 
 #include "unionFindLib.decl.h"
 #include <NDMeshStreamer.h>
+#include <unordered_map>
+#include "locators.h"
+#include "unionFindStats.h"
+#include "linkParticles.h"
+#include "clusterLevels.h"
+#include "partitionVertices.h"
+#include "componentAggregates.h"
 
+// vertex record used to hand vertices to the library and read back results
+// library keeps its own structure-of-arrays copy (see UnionFindLib)
+// roots are given with parent -1 or their own vertexID, and are returned
+// pointing to themselves
 struct unionFindVertex {
     long int vertexID;
     long int parent;
     long int componentNumber = -1;
-    std::vector<long int> need_boss_requests; //request queue for processing need_boss requests
-    long int findOrAnchorCount = 0;
 
     void pup(PUP::er &p) {
         p|vertexID;
         p|parent;
         p|componentNumber;
-        p|need_boss_requests;
     }
 };
 
-struct componentCountMap {
-    long int compNum;
-    int count;
+// pending need_boss request, chained per vertex through a pooled list
+struct needBossRequest {
+    int requestorChare;
+    int requestorIdx;
+    int next; // index of next request in pool, -1 terminates
+};
+PUPbytes(needBossRequest)
+
+// batch of find / same-component queries issued on one chare (see find_roots)
+struct queryBatch {
+    std::vector<long int> vertices; // queried vertex IDs, two per pair for same_components
+    std::vector<long int> roots;    // root found for each queried vertex
+    long int outstanding;           // queries still waiting on other chares
+    bool pairs;
+    CkCallback cb;
 
     void pup(PUP::er &p) {
-        p|compNum;
-        p|count;
+        p|vertices;
+        p|roots;
+        p|outstanding;
+        p|pairs;
+        p|cb;
     }
 };
 
+inline bool compare_count_maps(const componentCountMap &a, const componentCountMap &b) {
+    return a.compNum < b.compNum;
+}
+
+void merge_sorted_count_maps(const std::vector< std::pair<const componentCountMap*, int> > &lists,
+        std::vector<componentCountMap> &result);
+
+// Phase 1 union algorithms, selected at unionFindInit
+enum unionAlgorithm {
+    FIND_BOSS_UNION, // find_boss1/find_boss2: find both roots, link the larger one
+    ANCHOR_UNION,    // anchor: climb from the larger vertex, swap sides when passing the smaller
+    REM_UNION,       // Rem's algorithm with splicing: compresses paths while climbing
+    NUM_UNION_ALGORITHMS
+};
+// command line names of union algorithms: findboss, anchor, rem
+const char* union_algorithm_name(unionAlgorithm algorithm);
+// NUM_UNION_ALGORITHMS for unknown names
+unionAlgorithm union_algorithm_from_name(const char *name);
+PUPbytes(unionAlgorithm)
+
+// Phase 2 labeling engines
+enum labelingMode {
+    NEED_BOSS_LABELING,      // per-vertex need_boss/set_component messages
+    POINTER_JUMPING_LABELING // batched bulk-synchronous pointer jumping rounds
+};
+PUPbytes(labelingMode)
+
+// numbering of the components found by find_components
+enum componentNumbering {
+    SCAN_NUMBERING,   // 0, 1, ... in (PE, chare, index) order of the roots
+    ROOT_ID_NUMBERING // the root's vertex ID, i.e. the smallest vertex ID of the component
+};
+PUPbytes(componentNumbering)
 
-/* global variables */
-/*readonly*/ extern CkGroupID libGroupID;
-// declaration for custom reduction
+// detection of the end of a messaging phase (Phase 1, sampling stages,
+// exchange of pruning counts)
+enum completionDetection {
+    QUIESCENCE_DETECTION, // CkStartQD, waits for all messages of the program
+    COUNTED_COMPLETION    // waves over the library's sent/received message counts
+};
+PUPbytes(completionDetection)
+
+// message prioritization policies, combined as a bit mask
+enum messagePriorityPolicy {
+    PRIORITY_NONE = 0,
+    PRIORITY_COMPLETING_UNIONS = 1, // find_boss2 steps ahead of find_boss1 steps
+    PRIORITY_PATH_UPDATES = 2,      // short-circuit updates ahead of finds
+    PRIORITY_LARGE_QUEUES = 4,      // set_component replies of long need_boss queues first
+    PRIORITY_ALL = 7
+};
+// Charm++ priorities of prioritized library messages; lower values are
+// delivered first, all other messages have the default priority 0
+const int PATH_UPDATE_PRIORITY = -2;
+const int COMPLETING_UNION_PRIORITY = -1;
+// command line names: none, unions, paths, queues or all, comma separated;
+// -1 for unknown names
+int message_priorities_from_names(const char *names);
+
+// locators hold values only, except the application's function or tables
+// (FUNCTION_LOCATOR, TABLE_LOCATOR), which are only valid in the same binary;
+// range locators registered by partition_vertices are restored on unpacking
+PUPbytes(vertexLocator)
+
+// declaration for custom reductions, shared by all library instances
 extern CkReduction::reducerType mergeCountMapsReductionType;
+extern CkReduction::reducerType mergeStatsReductionType;
+
+// library group chare class declarations
+// one per PE and library instance, holds the runtime statistics of the
+// instance's library chares on the PE
+class UnionFindLibGroup : public CBase_UnionFindLibGroup {
+    public:
+    unionFindStats stats;
+    int timerDepth; // nesting of library calls being timed
+    double timerStart;
+    // root counts of the library chares on this PE for component numbering,
+    // and their array, which receives the first numbers
+    std::map<int, long int> localRootCounts;
+    CkArrayID libArrayID;
+    // library messages sent and received on this PE, for counted completion;
+    // kept apart from stats, which may be reset between phases
+    long int sentMessages;
+    long int receivedMessages;
+    // callback and totals of the previous wave of the running detection
+    CkCallback completionCb;
+    long int lastWaveSent;
+    long int lastWaveReceived;
+    UnionFindLibGroup() {
+        stats.reset();
+        timerDepth = 0;
+        sentMessages = 0;
+        receivedMessages = 0;
+    }
+    void contribute_statistics(CkCallback cb, bool reset);
+    void reset_statistics();
+    void root_counts_gathered(CkReductionMsg *msg);
+    void receive_root_offset(long int peOffset, long int totalCount);
+    void completion_wave(CkCallback cb, long int lastSent, long int lastReceived);
+    void completion_wave_done(CkReductionMsg *msg);
+};
+
+// charges the wall time of the outermost library call on a PE to a phase,
+// and to the load of the library chare it was called on, if given;
+// nested calls (e.g. TRAM items handled inline) are not counted twice
+class libPhaseTimer {
+    UnionFindLibGroup *group;
+    int phase;
+    double *load;
+    public:
+    libPhaseTimer(UnionFindLibGroup *g, libPhase p, double *chareLoad = NULL) :
+        group(g), phase(p), load(chareLoad) {
+        if (group->timerDepth++ == 0)
+            group->timerStart = CkWallTimer();
+    }
+    ~libPhaseTimer() {
+        if (--group->timerDepth == 0) {
+            double elapsed = CkWallTimer() - group->timerStart;
+            group->stats.phaseTime[phase] += elapsed;
+            if (load != NULL)
+                *load += elapsed;
+        }
+    }
+};
+
+class UnionFindLib;
+
+// library nodegroup chare, one per process; registry of the library chares
+// resident on the node, used when the node forest is shared (see node_chare)
+class UnionFindLibNode : public CBase_UnionFindLibNode {
+    std::vector<UnionFindLib*> residentChares; // indexed by chare, NULL if not on this node
+    public:
+    UnionFindLibNode(int nChares) : residentChares(nChares, (UnionFindLib*)NULL) {}
+    // registered chares must have their vertex arrays in place already
+    void register_chare(int chareIdx, UnionFindLib *c) {
+        __atomic_store_n(&residentChares[chareIdx], c, __ATOMIC_RELEASE);
+    }
+    void unregister_chare(int chareIdx) {
+        __atomic_store_n(&residentChares[chareIdx], (UnionFindLib*)NULL, __ATOMIC_RELEASE);
+    }
+    UnionFindLib* resident_chare(int chareIdx) const {
+        return __atomic_load_n(&residentChares[chareIdx], __ATOMIC_ACQUIRE);
+    }
+};
 
 // class definition for library chares
 class UnionFindLib : public CBase_UnionFindLib {
-    unionFindVertex *myVertices;
+    // structure-of-arrays vertex storage, indexed by local array index
+    std::vector<long int> vertexIDs;
+    std::vector<long int> parents;
+    std::vector<long int> componentNumbers;
+#ifdef PROFILING
+    std::vector<unsigned int> findOrAnchorCounts;
+#endif
+    // need_boss request lists: per-vertex head into a per-chare pool,
+    // allocated for labeling and freed in bulk afterwards
+    std::vector<int> requestHead;
+    std::vector<needBossRequest> requestPool;
+    unionFindVertex *myAppVertices; // application array for write-back, may be NULL
     int numMyVertices;
     int pathCompressionThreshold = 5;
     int componentPruneThreshold;
-    std::pair<int, int> (*getLocationFromID)(long int vid);
-    int myLocalNumBosses;
-    int totalNumBosses;
+    vertexLocator locator;
+    int numChares;
+    unionAlgorithm unionAlgo;
+    long int myLocalNumBosses;
+    long int totalNumBosses;
     CkCallback postComponentLabelingCb;
+    CkCallback postPruningCb;
+    labelingMode labelMode = NEED_BOSS_LABELING;
+    componentNumbering numbering = SCAN_NUMBERING;
+    completionDetection completion = QUIESCENCE_DETECTION;
+    int messagePriorities = PRIORITY_NONE;
+    CkCallback phaseBarrierCb;
+    // labels (or label lookups) this chare still waits for; labeling ends
+    // locally once all arrived, no quiescence is needed
+    long int pendingLabels = 0;
+    bool labelingStarted = false;
+    // pruning: count replies still expected from owners, plus one until this
+    // chare has replied as an owner itself
+    int pendingCountReplies = 0;
+    // pointer jumping state: (vertex, slot in request) waiting on each chare
+    std::map< int, std::vector< std::pair<int, int> > > jumpBatches;
+    int outstandingJumpReplies;
+    // sparse component counts for pruning
+    std::vector<componentCountMap> myComponentCounts; // totals for local components
+    std::vector< std::vector<componentCountMap> > receivedCounts; // owner side partial counts
+    std::vector<int> receivedCountSenders;
+    std::vector<bool> prunedVertices; // labels are kept, pruning only hides them
+    // incremental labeling across epochs
+    bool incrementalLabeling = false;
+    bool labelsValid = false; // forest has been labeled at least once
+    long int numComponentLabels = 0; // labels handed out so far are in [0, numComponentLabels)
+    std::vector<bool> wasRoot; // labeled roots of the previous epoch
+    std::vector<long int> labelMerges; // (old label, new label) pairs of absorbed roots
+    CkCallback postInvalidationCb;
+    // multi-threshold clustering (cluster_weighted_edges)
+    levelClusterer clusterer;
+    friend class levelClusterer;
+    // locality-aware partitioning before initialize_vertices (partition_vertices)
+    vertexPartitioner partitioner;
+    friend class vertexPartitioner;
+    // per-component aggregates (aggregate_components)
+    componentAggregator aggregator;
+    friend class componentAggregator;
+    // group and nodegroup of this library instance
+    CkGroupID libGroupID;
+    CkGroupID libNodeGroupID;
+    UnionFindLibGroup *localGroup = NULL; // statistics of this PE, looked up on first use
+    // shared node forest: trees are climbed and linked in memory across all
+    // library chares of the node, not only within this chare
+    bool shareNodeForest = false;
+    UnionFindLibNode *localNode = NULL;
+    // open query batches of this chare, and roots found by earlier queries
+    // for vertices of other chares; roots stay ancestors of these vertices
+    // as long as no trees are reset
+    std::map<int, queryBatch> queryBatches;
+    int nextQueryBatch = 0;
+    std::unordered_map<long int, long int> rootCache;
+    // buffered edges for local edge pre-pass
+    bool bufferUnionRequests = false;
+    std::vector< std::pair<long int, long int> > bufferedUnionRequests;
+    // redundant edge filter: sequential union-find over the endpoints of the
+    // union requests this chare has sent, keyed by vertex ID
+    bool filterUnionRequests = false;
+    std::unordered_map<long int, long int> filterParents;
+    // sampling (two-stage) Phase 1: boundary edges beyond the first few of
+    // each local tree wait until the giant component is known
+    int samplesPerTree = 0; // 0: sampling disabled
+    int giantRootSamples = 1024; // vertices sampled over all chares
+    CkCallback samplingPhaseOneCb;
+    std::vector< std::pair<long int, long int> > deferredUnionRequests;
+    std::vector<int> sampleTopSlot; // per vertex, slot of its local top in sampleTopRoots
+    std::vector<long int> sampleTopRoots;
+    long int giantRoot = -1;
+    // geometric front end (link_particles)
+    particleLinker linker;
+    friend class particleLinker;
+    // measurement-based load balancing: busy time of library calls on this
+    // chare since the last load balancing step, reported as its load
+    bool loadBalancing = false;
+    double chareLoad = 0;
+    CkCallback postLoadBalancingCb;
 
     public:
-    UnionFindLib() {}
+    UnionFindLib(int nChares, int algorithm, bool shareNode, bool lb, CkGroupID groupID,
+            CkGroupID nodeGroupID);
     UnionFindLib(CkMigrateMessage *m) { }
-    static CProxy_UnionFindLib unionFindInit(CkArrayID clientArray, int n);
+    ~UnionFindLib();
+    void pup(PUP::er &p);
+    void ckJustMigrated();
+    static CProxy_UnionFindLib unionFindInit(CkArrayID clientArray, int n,
+            unionAlgorithm algorithm = FIND_BOSS_UNION, bool shareNodeForest = false,
+            bool loadBalancing = false);
+    void reattach_vertices(unionFindVertex *appVertices);
+    void load_balance(CkCallback cb);
+    void UserSetLBLoad();
+    void ResumeFromSync();
+    unionAlgorithm get_union_algorithm() const {
+        return unionAlgo;
+    }
     void register_phase_one_cb(CkCallback cb);
+    void set_completion_detection(completionDetection mode);
+    void union_requests_done(CkCallback cb);
+    void phase_barrier(CkCallback cb);
+    void phase_barrier_reached();
+    void wait_for_completion(CkCallback cb);
+    void set_message_priorities(int policies);
+    void partition_vertices(const long int *vids, const double *positions, int numVertices,
+            const long int *edgeList, long int numEdges, const vertexLocator &inputLocator, CkCallback cb) {
+        partitioner.partition_vertices(*this, vids, positions, numVertices, edgeList, numEdges,
+                inputLocator, cb);
+    }
+    void partition_bounds_found(CkReductionMsg *msg) {
+        partitioner.partition_bounds_found(*this, msg);
+    }
+    void partition_samples_gathered(CkReductionMsg *msg) {
+        partitioner.partition_samples_gathered(*this, msg);
+    }
+    void receive_partition_vertices(std::vector<long int> ids, std::vector<long int> keys,
+            std::vector<double> positions) {
+        partitioner.receive_partition_vertices(*this, ids, keys, positions);
+    }
+    void partition_counts_done(CkReductionMsg *msg) {
+        partitioner.partition_counts_done(*this, msg);
+    }
+    void store_partition_ids(std::vector<long int> oldIDs, std::vector<long int> newIDs) {
+        partitioner.store_partition_ids(*this, oldIDs, newIDs);
+    }
+    void partition_directory_done() {
+        partitioner.partition_directory_done(*this);
+    }
+    void lookup_partition_ids(int fromChare, std::vector<long int> oldIDs) {
+        partitioner.lookup_partition_ids(*this, fromChare, oldIDs);
+    }
+    void receive_partition_ids(std::vector<long int> oldIDs, std::vector<long int> newIDs) {
+        partitioner.receive_partition_ids(*this, oldIDs, newIDs);
+    }
+    void partition_lookups_done() {
+        partitioner.partition_lookups_done(*this);
+    }
+    void union_partitioned_edges() {
+        partitioner.union_partitioned_edges(*this);
+    }
+    const std::vector<long int>& get_partitioned_ids() const {
+        return partitioner.get_partitioned_ids();
+    }
+    const std::vector<double>& get_partitioned_positions() const {
+        return partitioner.get_partitioned_positions();
+    }
     void initialize_vertices(unionFindVertex *appVertices, int numVertices);
-#ifndef ANCHOR_ALGO
+    void initialize_vertices(const long int *appVertexIDs, int numVertices);
     void union_request(long int vid1, long int vid2);
-    void find_boss1(int arrIdx, long int partnerID, long int senderID);
-    void find_boss2(int arrIdx, long int boss1ID, long int senderID);
-#else
-    void union_request(long int v, long int w);
-    void anchor(int w_arrIdx, long int v, long int path_base_arrIdx);
-#endif
-    void local_path_compression(unionFindVertex *src, long int compressedParent);
+    void union_requests(const long int *edgeList, long int numEdges);
+    void buffer_union_requests(bool enable);
+    void flush_union_requests();
+    void filter_union_requests(bool enable);
+    long int filter_key(long int vid);
+    long int filter_find(long int vid);
+    void submit_union_request(long int vid1, long int vid2);
+    void sample_union_requests(int samples, CkCallback cb);
+    void sample_boundary_requests(const std::vector< std::pair<long int, long int> > &boundaryRequests);
+    void sampling_stage_sent();
+    void resolve_sample_roots();
+    void sample_roots_found(CkDataMsg *msg);
+    void giant_root_found(CkReductionMsg *msg);
+    void check_giant_edges(std::vector<int> arrIdxs, std::vector<long int> partners);
+    void deferred_stage_sent();
+    void sampling_done();
+    inline bool in_giant_component(int arrIdx) const {
+        return giantRoot != -1 && sampleTopRoots[sampleTopSlot[arrIdx]] == giantRoot;
+    }
+    void link_particles(const double *positions, int numParticles, double linkLength, CkCallback cb) {
+        linker.link_particles(*this, positions, numParticles, linkLength, cb);
+    }
+    void particle_boxes_gathered(CkReductionMsg *msg) {
+        linker.particle_boxes_gathered(*this, msg);
+    }
+    void link_ghost_particles(std::vector<long int> ghostIDs, std::vector<double> ghostPositions) {
+        linker.link_ghost_particles(*this, ghostIDs, ghostPositions);
+    }
+    bool local_union(int arrIdx1, int arrIdx2);
+    int find_local_root(int arrIdx);
+    void send_union_request(long int vid1, long int vid2);
+    void send_find_boss_request(long int vid1, long int vid2);
+    void send_find_boss(int chareIdx, const findBossData &data);
+    void prioritized_find_boss(const findBossData &data);
+    void find_boss1(int arrIdx, long int partnerID, long int senderID, int hops);
+    void find_boss2(int arrIdx, long int boss1ID, long int senderID, int hops);
+    void climb_boss1(UnionFindLib *c, int arrIdx, long int partnerID, long int senderID, int hops);
+    void climb_boss2(UnionFindLib *c, int arrIdx, long int boss1ID, long int senderID, int hops);
+    void send_anchor_request(long int v, long int w);
+    void anchor(int w_arrIdx, long int v, long int path_base_arrIdx, int hops);
+    void climb_anchor(UnionFindLib *c, int w_arrIdx, long int v, UnionFindLib *base_c, long int path_base_arrIdx, int hops);
+    void send_rem_request(long int v, long int w);
+    void climb_rem(UnionFindLib *c, int arrIdx, long int v, int hops);
+    void local_path_compression(int srcIdx, long int compressedParent);
+    void node_path_compression(UnionFindLib *c, int srcIdx, long int compressedParent);
+    void short_circuit_sender(long int senderID, long int currID, long int grandparentID);
     bool check_same_chares(long int v1, long int v2);
     void short_circuit_parent(shortCircuitData scd);
+    void prioritized_short_circuit(shortCircuitData scd);
     void compress_path(int arrIdx, long int compressedParent);
     unionFindVertex* return_vertices();
     void registerGetLocationFromID(std::pair<int, int> (*gloc)(long int v));
+    void registerLocator(const vertexLocator &loc);
+    inline std::pair<int, int> getLocationFromID(long int vid) const {
+        return locator.locate(vid);
+    }
+    // parent accesses of Phase 1; with a shared node forest, library chares
+    // on other PEs of the node climb and link these entries concurrently
+    inline long int load_parent(int arrIdx) const {
+        return __atomic_load_n(&parents[arrIdx], __ATOMIC_RELAXED);
+    }
+    inline void store_parent(int arrIdx, long int parent) {
+        __atomic_store_n(&parents[arrIdx], parent, __ATOMIC_RELAXED);
+    }
+    // set parent only if it is still expected, e.g. to link a root
+    inline bool cas_parent(int arrIdx, long int expected, long int parent) {
+        return __atomic_compare_exchange_n(&parents[arrIdx], &expected, parent, false,
+                __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+    }
+    // roots point to themselves with every union algorithm
+    inline bool is_root(int arrIdx) const {
+        return load_parent(arrIdx) == vertexIDs[arrIdx];
+    }
+    long int get_component(int arrIdx) const {
+        return prunedVertices[arrIdx] ? -1 : componentNumbers[arrIdx];
+    }
+    long int get_parent(int arrIdx) const {
+        return parents[arrIdx];
+    }
+    inline UnionFindLibGroup* lib_group() {
+        if (localGroup == NULL)
+            localGroup = CProxy_UnionFindLibGroup(libGroupID).ckLocalBranch();
+        return localGroup;
+    }
+    inline UnionFindLibNode* lib_node() {
+        if (localNode == NULL)
+            localNode = CProxy_UnionFindLibNode(libNodeGroupID).ckLocalBranch();
+        return localNode;
+    }
+    // chare whose vertex arrays hold chare index chareIdx, if they can be
+    // accessed in memory from here: this chare, or with a shared node forest
+    // any registered chare of the node. NULL if chareIdx must be messaged.
+    inline UnionFindLib* node_chare(int chareIdx) {
+        if (chareIdx == thisIndex)
+            return this;
+        if (!shareNodeForest)
+            return NULL;
+        return lib_node()->resident_chare(chareIdx);
+    }
+    inline unionFindStats& stats() {
+        return lib_group()->stats;
+    }
+    inline void count_message(libMessageType type, size_t bytes) {
+        UnionFindLibGroup *g = lib_group();
+        g->stats.messages[type]++;
+        g->stats.bytes[type] += bytes;
+        g->sentMessages++;
+    }
+    // counterpart of count_message, at the start of every entry method
+    // receiving a counted message
+    inline void message_received() {
+        lib_group()->receivedMessages++;
+    }
+    void collect_statistics(CkCallback cb, bool reset);
+    void reset_statistics();
 
     // functions and data structures for finding connected components
 
     public:
     void find_components(CkCallback cb);
-    void boss_count_prefix_done(int totalCount);
+    void boss_count_total_done(long int totalCount);
+    void boss_count_prefix_done(long int startIndex, long int totalCount);
+    void set_component_numbering(componentNumbering mode);
     void start_component_labeling();
-    void insertDataNeedBoss(const uint64_t & data);
+    void check_labeling_done();
+    void component_labeling_done();
+    void set_labeling_mode(labelingMode mode);
+    void pointer_jumping_round();
+    void jump_request(int fromChare, std::vector<int> parentIdxs);
+    void jump_reply(int fromChare, std::vector<long int> grandparents, std::vector<long int> components);
+    void pointer_jumping_round_complete();
+    void pointer_jumping_round_done(long int totalUnlabeled);
+    void set_incremental_labeling(bool enable);
+    inline bool incremental_pass() const {
+        return incrementalLabeling && labelsValid;
+    }
+    void relabel_changed_trees(long int totalRoots);
+    void find_label(int arrIdx, int requestorChare, int requestorIdx, int hops);
+    void lookup_label(int arrIdx, int requestorChare, int requestorIdx, int hops);
+    void receive_label(int arrIdx, long int label);
+    void apply_label(int arrIdx, long int label);
+    void collect_label_merges();
+    void apply_label_merges(CkReductionMsg *msg);
+    void invalidate_vertices(const std::vector<int> &arrIdxs, CkCallback cb);
+    void reset_components(CkReductionMsg *msg);
+    void cluster_weighted_edges(const long int *edgeList, const double *weights, long int numEdges,
+            const std::vector<double> &thresholds, CkCallback cb) {
+        clusterer.cluster_weighted_edges(*this, edgeList, weights, numEdges, thresholds, cb);
+    }
+    void cluster_level_unions_done() {
+        clusterer.cluster_level_unions_done(*this);
+    }
+    void cluster_level_labeled() {
+        clusterer.cluster_level_labeled(*this);
+    }
+    long int get_level_component(int level, int arrIdx) const {
+        return clusterer.get_level_component(level, arrIdx);
+    }
+    void insertDataNeedBoss(const needBossData & data);
     void insertDataFindBoss(const findBossData & data);
-#ifdef ANCHOR_ALGO
     void insertDataAnchor(const anchorData & data);
-#endif
-    void need_boss(int arrIdx, long int fromID);
+    void insertDataRem(const anchorData & data);
+    void need_boss(int arrIdx, int requestorChare, int requestorIdx);
     void set_component(int arrIdx, long int compNum);
+    void assign_component(int arrIdx, long int compNum);
     void prune_components(int threshold, CkCallback appReturnCb);
+    int get_component_owner(long int compNum);
+    void add_component_counts(int fromChare, std::vector<componentCountMap> counts);
+    void return_component_counts();
+    void receive_component_counts(std::vector<componentCountMap> totals);
+    void count_reply_received();
+    long int get_component_count(long int compNum);
     void perform_pruning();
-    int get_total_num_bosses() {
+
+    // per-component aggregates (halo catalogs), after find_components
+    int register_aggregate(const double *values, int width, aggregateOperator op) {
+        return aggregator.register_aggregate(*this, values, width, op);
+    }
+    void clear_aggregates() {
+        aggregator.clear_aggregates();
+    }
+    void aggregate_components(long int threshold, CkCallback cb) {
+        aggregator.aggregate_components(*this, threshold, cb);
+    }
+    void add_component_aggregates(std::vector<long int> comps, std::vector<long int> counts,
+            std::vector<double> rows) {
+        aggregator.add_component_aggregates(*this, comps, counts, rows);
+    }
+    void finish_component_aggregates() {
+        aggregator.finish_component_aggregates(*this);
+    }
+    // results of the components owned by this chare, sorted by component
+    int num_aggregated_components() const {
+        return aggregator.num_aggregated_components();
+    }
+    long int get_aggregated_component(int k) const {
+        return aggregator.get_aggregated_component(k);
+    }
+    long int get_aggregated_count(int k) const {
+        return aggregator.get_aggregated_count(k);
+    }
+    const double* get_aggregated_values(int k, int aggregate) const {
+        return aggregator.get_aggregated_values(k, aggregate);
+    }
+
+    // batched find / same-component queries on the forest, without labeling
+    void find_roots(const long int *vids, int numVids, CkCallback cb);
+    void same_components(const long int *pairs, int numPairs, CkCallback cb);
+    void clear_query_cache();
+    void start_query_batch(int batch);
+    long int climb_to_root(long int vid, long int &next);
+    void resolve_roots(int originChare, int batch, std::vector<int> slots, std::vector<long int> vids);
+    void receive_roots(int batch, std::vector<int> slots, std::vector<long int> roots);
+    void store_roots(int batch, const std::vector<int> &slots, const std::vector<long int> &roots);
+    void finish_query_batch(int batch);
+    long int get_total_num_bosses() {
         return totalNumBosses;
     }
     //void merge_count_results(CkReductionMsg *msg);
     //void merge_count_results(int* totalCounts, int numElems);
-#ifdef PROFILING
-    void profiling_count_max(long int maxCount);
-#endif
 };
 
-// library group chare class declarations
-class UnionFindLibGroup : public CBase_UnionFindLibGroup {
-    bool map_built;
-    int* component_count_array;
-    int thisPeMessages; //for profiling
-    public:
-    UnionFindLibGroup() {
-        map_built = false;
-        thisPeMessages = 0;
-    }
-    void build_component_count_array(int* totalCounts, int numComponents);
-    int get_component_count(long int component_id);
-    void increase_message_count();
-    void contribute_count();
-    void done_profiling(int);
-};
 
 
 
@@ -0,0 +1,84 @@
+#ifndef UNION_FIND_SHARED
+#define UNION_FIND_SHARED
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "unionFindLib.h"
+
+/* Shared-memory union-find engine
+   Node-local alternative to the chare array library for problems that fit
+   in one process. It takes the same inputs (unionFindVertex arrays or vertex
+   IDs per partition, a vertex locator and union requests) and produces the
+   same results as find_components and prune_components, but works on one
+   flat forest with lock-free linking and path halving, using worker threads
+   instead of messages.
+
+   Partitions play the role of library chares: partition p holds the vertices
+   the locator maps to chare p. Component numbers follow the same contract as
+   the chare library: every component is rooted at its smallest vertex ID,
+   and roots are numbered 0, 1, ... in (partition, index) order.
+
+   All partitions must be registered before the first union request. Union
+   requests may be issued concurrently (e.g. from chares on several PEs of an
+   SMP process); find_components and prune_components must not overlap with
+   them. The engine is not shared across processes, so the application must
+   run in a single process (one PE, or an SMP build on one node).
+*/
+class UnionFindShared {
+    int numPartitions;
+    int numThreads;
+    vertexLocator locator;
+    // registered partitions, flattened on first use
+    std::vector<unionFindVertex*> partitionAppVertices; // NULL for ID-only partitions
+    std::vector< std::vector<long int> > partitionVertexIDs; // copies for ID-only partitions
+    std::vector<int> partitionSizes; // -1 until registered
+    std::vector<long int> partitionOffsets; // flat index of first vertex of each partition
+    std::mutex registerLock;
+    std::atomic<bool> flattened;
+    // flat forest, parents are flat indices and roots point to themselves
+    long int numVertices;
+    std::vector<long int> vertexIDs;
+    std::atomic<long int> *parents;
+    std::vector<long int> componentNumbers;
+    std::vector<char> prunedVertices; // written by several threads, so not vector<bool>
+    long int totalNumBosses;
+
+    UnionFindShared(int nPartitions, int nThreads);
+    void flatten();
+    long int flat_index(long int vid) const {
+        std::pair<int, int> loc = locator.locate(vid);
+        return partitionOffsets[loc.first] + loc.second;
+    }
+    long int find_root(long int x);
+    void unite(long int x, long int y);
+    void write_back();
+    int num_chunks(long int n) const;
+    template <typename F> void parallel_for(long int n, F body);
+    template <typename F> void for_each_vertex(F f);
+
+    public:
+    ~UnionFindShared();
+    // replaces UnionFindLib::unionFindInit; numThreads <= 0 uses all hardware threads
+    static UnionFindShared* unionFindSharedInit(int numPartitions, int numThreads = 0);
+    void initialize_vertices(int partition, unionFindVertex *appVertices, int numVertices);
+    void initialize_vertices(int partition, const long int *appVertexIDs, int numVertices);
+    void registerGetLocationFromID(std::pair<int, int> (*gloc)(long int v));
+    void registerLocator(const vertexLocator &loc);
+    void union_request(long int vid1, long int vid2);
+    void union_requests(const long int *edgeList, long int numEdges);
+    void find_components();
+    void prune_components(int threshold);
+    long int get_component(int partition, int arrIdx) const {
+        long int i = partitionOffsets[partition] + arrIdx;
+        return prunedVertices[i] ? -1 : componentNumbers[i];
+    }
+    long int get_total_num_bosses() const {
+        return totalNumBosses;
+    }
+    int get_num_threads() const {
+        return numThreads;
+    }
+};
+
+#endif
@@ -0,0 +1,116 @@
+#ifndef UNION_FIND_STATS
+#define UNION_FIND_STATS
+
+#include <string.h>
+
+// library message types, counted separately in unionFindStats
+enum libMessageType {
+    MSG_FIND_BOSS,        // find_boss1/find_boss2 (TRAM items)
+    MSG_ANCHOR,           // anchor (TRAM items)
+    MSG_REM,              // Rem's algorithm steps (TRAM items)
+    MSG_SHORT_CIRCUIT,    // grandparent short-circuiting
+    MSG_COMPRESS_PATH,
+    MSG_NEED_BOSS,        // need_boss (TRAM items)
+    MSG_SET_COMPONENT,
+    MSG_JUMP_REQUEST,     // pointer jumping batches
+    MSG_JUMP_REPLY,
+    MSG_FIND_LABEL,       // incremental label lookups
+    MSG_RECEIVE_LABEL,
+    MSG_COMPONENT_COUNTS, // pruning counts to and from owners
+    MSG_QUERY_REQUEST,    // batched root queries
+    MSG_QUERY_REPLY,
+    MSG_GIANT_CHECK,      // deferred edges checked at the other endpoint (sampling)
+    MSG_GHOST_PARTICLES,  // boundary particles sent to neighbor chares (link_particles)
+    MSG_PARTITION,        // vertices and ID lookups of partition_vertices
+    MSG_COMPONENT_AGGREGATES, // partial aggregate rows to component owners
+    NUM_LIB_MESSAGE_TYPES
+};
+
+// library phases, wall time of library entry methods is charged to one of them
+enum libPhase {
+    PHASE_UNION,    // union requests and tree building (Phase 1)
+    PHASE_LABELING, // find_components, any labeling engine
+    PHASE_PRUNING,  // prune_components
+    PHASE_QUERY,    // find_roots, same_components
+    PHASE_PARTITION, // partition_vertices
+    PHASE_AGGREGATION, // aggregate_components
+    NUM_LIB_PHASES
+};
+
+// log2 bins: bin 0 holds 0, bin b > 0 holds [2^(b-1), 2^b), last bin is open
+#define STATS_HISTOGRAM_BINS 24
+
+inline int stats_histogram_bin(long int value) {
+    int bin = 0;
+    while (value > 0 && bin < STATS_HISTOGRAM_BINS - 1) {
+        value >>= 1;
+        bin++;
+    }
+    return bin;
+}
+
+/* Runtime statistics of the library, kept per PE in UnionFindLibGroup and
+   reduced over all PEs by UnionFindLib::collect_statistics. Plain data, so
+   that it can be contributed as raw bytes.
+   Hops are parent pointers followed while climbing trees: local hops are
+   followed in memory, remote hops cost a message. Path lengths are hops from
+   the vertex a climb started at to the root it reached (root searches of
+   union requests and incremental label lookups). Queue lengths are the sizes
+   of need_boss request lists when a vertex got its label.
+*/
+struct unionFindStats {
+    long int messages[NUM_LIB_MESSAGE_TYPES];
+    long int bytes[NUM_LIB_MESSAGE_TYPES];
+    long int localHops;
+    long int remoteHops;
+    long int filteredRequests; // union requests dropped as redundant (filter_union_requests)
+    long int giantSkippedRequests; // union requests within the giant component (sample_union_requests)
+    long int pathLengths[STATS_HISTOGRAM_BINS];
+    long int maxPathLength;
+    long int queueLengths[STATS_HISTOGRAM_BINS];
+    long int maxQueueLength;
+    long int maxFindOrAnchorVisits; // only with -DPROFILING
+    // busy time per phase: sum over PEs, and the least and most loaded PE
+    double phaseTime[NUM_LIB_PHASES];
+    double phaseTimeMin[NUM_LIB_PHASES];
+    double phaseTimeMax[NUM_LIB_PHASES];
+    int numPes;
+
+    void reset() {
+        memset(this, 0, sizeof(unionFindStats));
+        numPes = 1;
+    }
+
+    inline void record_path_length(long int length) {
+        pathLengths[stats_histogram_bin(length)]++;
+        if (length > maxPathLength)
+            maxPathLength = length;
+    }
+
+    inline void record_queue_length(long int length) {
+        queueLengths[stats_histogram_bin(length)]++;
+        if (length > maxQueueLength)
+            maxQueueLength = length;
+    }
+
+    long int total_messages() const {
+        long int total = 0;
+        for (int t = 0; t < NUM_LIB_MESSAGE_TYPES; t++)
+            total += messages[t];
+        return total;
+    }
+
+    long int total_bytes() const {
+        long int total = 0;
+        for (int t = 0; t < NUM_LIB_MESSAGE_TYPES; t++)
+            total += bytes[t];
+        return total;
+    }
+
+    void merge(const unionFindStats &other);
+    void print() const;
+    static const char* message_type_name(int type);
+    static const char* phase_name(int phase);
+};
+
+#endif